@@ -1,5 +1,6 @@
 #include "board.h"
 #include "engine.h"
+#include "mem.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
@@ -76,37 +77,61 @@ void recommend_moves(struct config *board) {
     }
 }
 
+// Generate one piece's moves into local_configs, then append them to successors
+static void collect_piece_moves(struct config *conf, int i, int j, struct config *local_configs, struct config *successors, int *num_successors) {
+    int local_successors = 0;
+    switch (conf->board[i][j]) {
+        case 'P': case 'p': generate_pawn_moves(conf, i, j, local_configs, &local_successors); break;
+        case 'K': case 'k': generate_king_moves(conf, i, j, local_configs, &local_successors); break;
+        case 'Q': case 'q': generate_queen_moves(conf, i, j, local_configs, &local_successors); break;
+        case 'B': case 'b': generate_bishop_moves(conf, i, j, local_configs, &local_successors); break;
+        case 'N': case 'n': generate_knight_moves(conf, i, j, local_configs, &local_successors); break;
+        case 'R': case 'r': generate_rook_moves(conf, i, j, local_configs, &local_successors); break;
+    }
+
+    #pragma omp critical
+    {
+        for (int k = 0; k < local_successors; k++) {
+            successors[*num_successors] = local_configs[k];
+            (*num_successors)++;
+        }
+    }
+}
+
+// Threads without an arena keep the piece buffer on the stack; noinline keeps it out of other frames
+static __attribute__((noinline)) void collect_piece_moves_on_stack(struct config *conf, int i, int j, struct config *successors, int *num_successors) {
+    struct config local_configs[50];
+    collect_piece_moves(conf, i, j, local_configs, successors, num_successors);
+}
+
 // Generate all successors efficiently
 void generate_successors(struct config *conf, struct config *successors, int *num_successors) {
     *num_successors = 0; // Reset the count
 
-    #pragma omp parallel for collapse(2)
-    for (int i = 0; i < BOARD_SIZE; i++) {
-        for (int j = 0; j < BOARD_SIZE; j++) {
-            char piece = conf->board[i][j];
-
-            if ((conf->turn == MAX && piece >= 'A' && piece <= 'Z') ||
-                (conf->turn == MIN && piece >= 'a' && piece <= 'z')) {
-                int local_successors = 0;
-                struct config local_configs[50];
-                switch (piece) {
-                    case 'P': case 'p': generate_pawn_moves(conf, i, j, local_configs, &local_successors); break;
-                    case 'K': case 'k': generate_king_moves(conf, i, j, local_configs, &local_successors); break;
-                    case 'Q': case 'q': generate_queen_moves(conf, i, j, local_configs, &local_successors); break;
-                    case 'B': case 'b': generate_bishop_moves(conf, i, j, local_configs, &local_successors); break;
-                    case 'N': case 'n': generate_knight_moves(conf, i, j, local_configs, &local_successors); break;
-                    case 'R': case 'r': generate_rook_moves(conf, i, j, local_configs, &local_successors); break;
-                }
-
-                #pragma omp critical
-                {
-                    for (int k = 0; k < local_successors; k++) {
-                        successors[*num_successors] = local_configs[k];
-                        (*num_successors)++;
+    #pragma omp parallel
+    {
+        // One piece buffer per thread, taken from its arena when it has one
+        struct search_arena *arena = arena_get();
+        size_t mark = arena ? arena_mark(arena) : 0;
+        struct config *local_configs = arena ? arena_push(arena, 50) : NULL;
+
+        #pragma omp for collapse(2)
+        for (int i = 0; i < BOARD_SIZE; i++) {
+            for (int j = 0; j < BOARD_SIZE; j++) {
+                char piece = conf->board[i][j];
+
+                if ((conf->turn == MAX && piece >= 'A' && piece <= 'Z') ||
+                    (conf->turn == MIN && piece >= 'a' && piece <= 'z')) {
+                    if (local_configs) {
+                        collect_piece_moves(conf, i, j, local_configs, successors, num_successors);
+                    } else {
+                        collect_piece_moves_on_stack(conf, i, j, successors, num_successors);
                     }
                 }
             }
         }
+
+        if (arena) arena_release(arena, mark);
     }
 }
 
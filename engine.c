@@ -1,8 +1,30 @@
 #include "engine.h"
 #include "board.h"
+#include "mem.h"
 #include <stdio.h>
 #include <omp.h>
 #include <limits.h>
+#include <string.h>
+
+// Search every root successor in parallel and return the best one
+static struct config *best_successor(struct config *successors, int num_successors, int depth) {
+    int best_score = INT_MIN;
+    struct config *best_move = &successors[0];
+
+    // Parallelized minimax evaluation
+    #pragma omp parallel for
+    for (int i = 0; i < num_successors; i++) {
+        int score = minimax(successors[i], depth, MIN, INT_MIN, INT_MAX);
+        #pragma omp critical
+        {
+            if (score > best_score) {
+                best_score = score;
+                best_move = &successors[i];
+            }
+        }
+    }
+    return best_move;
+}
 
 // Engine chooses the best move
 void engine_move(struct config *board) {
@@ -18,39 +40,66 @@ void engine_move(struct config *board) {
         return;
     }
 
-    // Initialize best move
-    int best_score = INT_MIN;
-    struct config best_move = successors[0];
-
     // Determine depth dynamically based on game complexity
-    int depth = (num_successors > 30) ? 2 : 3; // Shallower depth for higher branching factor
+    int depth = (num_successors > 30) ? 2 : ENGINE_DEPTH; // Shallower depth for higher branching factor
 
-    // Parallelized minimax evaluation
-    #pragma omp parallel for
-    for (int i = 0; i < num_successors; i++) {
-        int score = minimax(successors[i], depth, MIN, INT_MIN, INT_MAX);
-        #pragma omp critical
-        {
-            if (score > best_score) {
-                best_score = score;
-                best_move = successors[i];
-            }
-        }
-    }
+    mem_reset_nodes();
+    double start = omp_get_wtime();
+    struct config *best_move = best_successor(successors, num_successors, depth);
+    double elapsed = omp_get_wtime() - start;
+    long long nodes = mem_nodes_searched();
+    printf("Searched %lld nodes in %.3f s (%.0f nodes/sec)\n",
+           nodes, elapsed, elapsed > 0 ? nodes / elapsed : 0.0);
 
     // Apply the best move
-    *board = best_move;
+    *board = *best_move;
 }
 
-// Minimax with Alpha-Beta Pruning
-int minimax(struct config board, int depth, int maximizingPlayer, int alpha, int beta) {
-    if (depth == 0 || is_game_over(&board)) {
-        return evaluate_board(&board);
+// Benchmark positions: opening, open middlegame, rook endgame (row 0 is rank 8)
+static const char *bench_positions[][BOARD_SIZE] = {
+    {"rnbqkbnr", "pppppppp", "        ", "        ", "        ", "        ", "PPPPPPPP", "RNBQKBNR"},
+    {"r bqk  r", "pppp bpp", "  n  n  ", "  b p   ", "  B P   ", "  NP N  ", "PPP  PPP", "R BQK  R"},
+    {"      k ", "pp   ppp", "        ", "   r    ", "        ", "        ", "PP   PPP", "   R  K "},
+};
+static const int bench_turns[] = {MAX, MIN, MAX};
+
+// Search fixed positions at a fixed depth and report nodes/sec
+void engine_bench(int depth) {
+    int num_positions = sizeof(bench_turns) / sizeof(bench_turns[0]);
+    long long total_nodes = 0;
+    double total_time = 0;
+
+    printf("Benchmark: %d positions, depth %d, %d threads\n", num_positions, depth, omp_get_max_threads());
+    for (int p = 0; p < num_positions; p++) {
+        struct config board;
+        for (int i = 0; i < BOARD_SIZE; i++) {
+            memcpy(board.board[i], bench_positions[p][i], BOARD_SIZE);
+        }
+        board.turn = bench_turns[p];
+
+        struct config successors[100];
+        int num_successors = 0;
+        generate_successors(&board, successors, &num_successors);
+
+        mem_reset_nodes();
+        double start = omp_get_wtime();
+        best_successor(successors, num_successors, depth);
+        double elapsed = omp_get_wtime() - start;
+        long long nodes = mem_nodes_searched();
+
+        printf("Position %d: %lld nodes in %.3f s (%.0f nodes/sec)\n",
+               p + 1, nodes, elapsed, elapsed > 0 ? nodes / elapsed : 0.0);
+        total_nodes += nodes;
+        total_time += elapsed;
     }
+    printf("Total: %lld nodes in %.3f s (%.0f nodes/sec)\n",
+           total_nodes, total_time, total_time > 0 ? total_nodes / total_time : 0.0);
+}
 
-    struct config successors[100];
+// Search the successors of board, generated into the given buffer
+static int search_successors(struct config *board, struct config *successors, int depth, int maximizingPlayer, int alpha, int beta) {
     int num_successors = 0;
-    generate_successors(&board, successors, &num_successors);
+    generate_successors(board, successors, &num_successors);
 
     if (maximizingPlayer == MAX) {
         int max_eval = INT_MIN;
@@ -83,7 +132,30 @@ int minimax(struct config board, int depth, int maximizingPlayer, int alpha, int
         }
         return min_eval;
     }
+}
+
+// Threads without an arena keep successors on the stack; noinline keeps them out of minimax's frame
+static __attribute__((noinline)) int search_on_stack(struct config *board, int depth, int maximizingPlayer, int alpha, int beta) {
+    struct config successors[100];
+    return search_successors(board, successors, depth, maximizingPlayer, alpha, beta);
+}
+
+// Minimax with Alpha-Beta Pruning
+int minimax(struct config board, int depth, int maximizingPlayer, int alpha, int beta) {
+    mem_count_node();
 
+    if (depth == 0 || is_game_over(&board)) {
+        return evaluate_board(&board);
+    }
+
+    // Successors live on the thread's node-local arena when it has one
+    struct search_arena *arena = arena_get();
+    if (!arena) return search_on_stack(&board, depth, maximizingPlayer, alpha, beta);
+
+    size_t mark = arena_mark(arena);
+    int score = search_successors(&board, arena_push(arena, 100), depth, maximizingPlayer, alpha, beta);
+    arena_release(arena, mark);
+    return score;
 }
 
 // Enhanced board evaluation function
@@ -3,8 +3,13 @@
 
 #include "board.h"
 
+#define ENGINE_DEPTH 3     // Deepest minimax() call made by engine_move()
+#define BENCH_DEPTH 5      // Default depth for engine_bench()
+#define MAX_SEARCH_DEPTH 5 // Deepest minimax() call allowed anywhere; sizes the search arenas
+
 // Engine Functions
 void engine_move(struct config *board); // Selects the best move for the computer
+void engine_bench(int depth);           // Fixed-position, fixed-depth nodes/sec benchmark
 
 // Minimax Algorithm with Alpha-Beta Pruning
 int minimax(struct config board, int depth, int maximizingPlayer, int alpha, int beta);
@@ -1,11 +1,25 @@
 #include "board.h"
 #include "engine.h"
+#include "mem.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
-int main() {
+int main(int argc, char *argv[]) {
     struct config board;
     init_board(&board);
+    mem_init(argv); // Bind search threads and place their arenas on local NUMA nodes
+
+    // Benchmark mode: chess_engine bench [depth]
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        int depth = (argc > 2) ? atoi(argv[2]) : BENCH_DEPTH;
+        if (depth < 1 || depth > MAX_SEARCH_DEPTH) {
+            printf("Benchmark depth must be between 1 and %d.\n", MAX_SEARCH_DEPTH);
+            return 1;
+        }
+        engine_bench(depth);
+        return 0;
+    }
 
     printf("Welcome to Optimized Chess Engine!\n");
     printf("You are White. Enter moves in standard chess notation (e.g., e2 e4).\n");
@@ -0,0 +1,223 @@
+#define _GNU_SOURCE // For MAP_HUGETLB and MADV_HUGEPAGE
+#include "mem.h"
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define MPOL_INTERLEAVE 3 // From <numaif.h>, so libnuma is not required
+#ifndef MAP_HUGE_2MB
+#define MAP_HUGE_2MB (21 << MAP_HUGE_SHIFT) // From <linux/mman.h>
+#endif
+#endif
+
+_Thread_local struct search_arena *mem_thread_arena;
+_Thread_local struct node_counter *mem_thread_counter;
+long long mem_stray_nodes;
+static struct node_counter *counter_list; // One counter per thread of the mem_init() team
+static int initialized;
+
+// CHESS_NUMA=0 turns off binding, arenas and huge pages, to compare against plain OpenMP
+static int mem_layer_enabled(void) {
+    const char *value = getenv("CHESS_NUMA");
+    return !(value && strcmp(value, "0") == 0);
+}
+
+// Round a request up to whole huge pages
+static size_t huge_page_round(size_t size) {
+    return (size + HUGE_PAGE_SIZE - 1) & ~((size_t)HUGE_PAGE_SIZE - 1);
+}
+
+#ifdef __linux__
+// Bitmask of online NUMA nodes, parsed from a list such as "0-1,3"
+static unsigned long online_nodes(void) {
+    unsigned long mask = 0;
+    FILE *f = fopen("/sys/devices/system/node/online", "r");
+    if (!f) return 0;
+
+    int first, last;
+    while (fscanf(f, "%d", &first) == 1) {
+        last = first;
+        int c = fgetc(f);
+        if (c == '-') {
+            if (fscanf(f, "%d", &last) != 1) break;
+            c = fgetc(f);
+        }
+        for (int n = first; n <= last && n < (int)(8 * sizeof(mask)); n++) {
+            mask |= 1UL << n;
+        }
+        if (c != ',') break;
+    }
+    fclose(f);
+    return mask;
+}
+#endif
+
+// Map memory backed by 2 MB pages, falling back to regular pages
+static void *map_pages(size_t size) {
+#ifdef __linux__
+    void *ptr = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_HUGE_2MB, -1, 0);
+    if (ptr != MAP_FAILED) return ptr;
+
+    // No reserved huge pages: ask for transparent huge pages instead.
+    // THP needs 2 MB alignment, so over-map and trim the unaligned head and tail.
+    char *raw = mmap(NULL, size + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) return NULL;
+    char *aligned = (char *)(((uintptr_t)raw + HUGE_PAGE_SIZE - 1) & ~((uintptr_t)HUGE_PAGE_SIZE - 1));
+    size_t head = aligned - raw;
+    if (head) munmap(raw, head);
+    munmap(aligned + size, HUGE_PAGE_SIZE - head);
+    madvise(aligned, size, MADV_HUGEPAGE);
+    return aligned;
+#else
+    return aligned_alloc(HUGE_PAGE_SIZE, size);
+#endif
+}
+
+static void unmap_pages(void *ptr, size_t size) {
+#ifdef __linux__
+    munmap(ptr, size);
+#else
+    (void)size;
+    free(ptr);
+#endif
+}
+
+// Allocate a table shared by all search threads
+void *mem_alloc_shared(size_t size) {
+    if (!mem_layer_enabled()) {
+        void *ptr = calloc(1, size);
+        if (!ptr) {
+            printf("Failed to allocate %zu bytes of shared memory.\n", size);
+            exit(EXIT_FAILURE);
+        }
+        return ptr;
+    }
+
+    size = huge_page_round(size);
+    void *ptr = map_pages(size);
+    if (!ptr) {
+        printf("Failed to allocate %zu bytes of shared memory.\n", size);
+        exit(EXIT_FAILURE);
+    }
+
+#ifdef __linux__
+    // Spread pages across sockets before first touch; ignored on single-node machines
+    unsigned long nodes = online_nodes();
+    if (nodes & (nodes - 1) &&
+        syscall(SYS_mbind, ptr, size, MPOL_INTERLEAVE, &nodes, 8 * sizeof(nodes), 0) != 0) {
+        printf("Failed to interleave %zu bytes of shared memory across NUMA nodes.\n", size);
+    }
+#endif
+
+    memset(ptr, 0, size);
+    return ptr;
+}
+
+void mem_free_shared(void *ptr, size_t size) {
+    if (!ptr) return;
+    if (mem_layer_enabled()) {
+        unmap_pages(ptr, huge_page_round(size));
+    } else {
+        free(ptr);
+    }
+}
+
+// Build the calling thread's arena; first touch places it on the thread's node.
+// Arenas are small, so they use regular pages and leave the huge-page pool to shared tables.
+static struct search_arena *arena_create(void) {
+    size_t size = sizeof(struct search_arena) + ARENA_BOARDS * sizeof(struct config);
+#ifdef __linux__
+    void *mem = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) mem = NULL;
+#else
+    void *mem = malloc(size);
+#endif
+    if (!mem) {
+        printf("Failed to allocate search arena.\n");
+        exit(EXIT_FAILURE);
+    }
+    memset(mem, 0, size);
+
+    // Header lives in the arena itself so it stays node-local
+    struct search_arena *arena = mem;
+    arena->base = (struct config *)(arena + 1);
+    arena->capacity = ARENA_BOARDS;
+    return arena;
+}
+
+static struct node_counter *counter_create(void) {
+    struct node_counter *counter = aligned_alloc(64, sizeof(*counter));
+    if (!counter) {
+        printf("Failed to allocate node counter.\n");
+        exit(EXIT_FAILURE);
+    }
+    counter->nodes = 0;
+
+    #pragma omp critical(mem_counter_list)
+    {
+        counter->next = counter_list;
+        counter_list = counter;
+    }
+    return counter;
+}
+
+void arena_overflow(struct search_arena *arena) {
+    printf("Search arena exhausted (%zu boards).\n", arena->capacity);
+    exit(EXIT_FAILURE);
+}
+
+// Bind threads through the OpenMP runtime, then build each thread's arena on its node
+void mem_init(char *argv[]) {
+    if (initialized) return; // Built once, so the counter list stays bounded
+    initialized = 1;
+    int enabled = mem_layer_enabled();
+
+#ifdef __linux__
+    // libgomp only reads binding settings at startup, so on multi-node machines set defaults
+    // and restart once. A single "spread" level keeps nesting disabled; a list would raise
+    // max-active-levels.
+    unsigned long nodes = online_nodes();
+    if (enabled && (nodes & (nodes - 1)) && !getenv("OMP_PLACES") && !getenv("OMP_PROC_BIND")) {
+        printf("%d NUMA nodes found: restarting with OMP_PLACES=cores OMP_PROC_BIND=spread.\n",
+               __builtin_popcountl(nodes));
+        fflush(stdout);
+        setenv("OMP_PLACES", "cores", 1);
+        setenv("OMP_PROC_BIND", "spread", 1);
+        execv("/proc/self/exe", argv);
+        printf("Restart failed; running without thread binding.\n");
+    }
+#else
+    (void)argv;
+#endif
+
+    #pragma omp parallel
+    {
+        mem_thread_counter = counter_create();
+        if (enabled) mem_thread_arena = arena_create();
+    }
+}
+
+// Node Statistics
+void mem_reset_nodes(void) {
+    mem_stray_nodes = 0;
+    for (struct node_counter *counter = counter_list; counter; counter = counter->next) {
+        counter->nodes = 0;
+    }
+}
+
+long long mem_nodes_searched(void) {
+    long long total = mem_stray_nodes;
+    for (struct node_counter *counter = counter_list; counter; counter = counter->next) {
+        total += counter->nodes;
+    }
+    return total;
+}
@@ -0,0 +1,76 @@
+#ifndef MEM_H
+#define MEM_H
+
+#include <stddef.h>
+#include "engine.h"
+
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+// Per-thread search stack: 100 successors per ply plus one piece's 50 moves (~24 KB)
+#define ARENA_BOARDS (MAX_SEARCH_DEPTH * 100 + 50)
+
+// Per-thread bump allocator for search state
+struct search_arena {
+    struct config *base;
+    size_t capacity; // In boards
+    size_t top;      // Next free board
+};
+
+// Setup: binds OpenMP threads and builds their arenas on the local node (off with CHESS_NUMA=0)
+void mem_init(char *argv[]);
+
+// Shared Tables (2 MB huge pages, interleaved across NUMA nodes)
+// Unused scaffolding: nothing in the engine calls these yet. They are meant for a future
+// transposition table; interleaving works per page, so small tables gain nothing.
+void *mem_alloc_shared(size_t size);
+void mem_free_shared(void *ptr, size_t size);
+
+// Per-thread node count, padded to a cache line so threads never share one
+struct node_counter {
+    long long nodes;
+    struct node_counter *next;
+    char pad[64 - sizeof(long long) - sizeof(void *)];
+};
+
+// Only threads of the mem_init() team own an arena and a counter; others see NULL
+extern _Thread_local struct search_arena *mem_thread_arena;
+extern _Thread_local struct node_counter *mem_thread_counter;
+extern long long mem_stray_nodes; // Nodes searched by threads outside that team
+
+// Search Stack (inline: called at every node)
+_Noreturn void arena_overflow(struct search_arena *arena);
+
+static inline struct search_arena *arena_get(void) {
+    return mem_thread_arena;
+}
+
+// Reserve count boards on top of the arena
+static inline struct config *arena_push(struct search_arena *arena, size_t count) {
+    if (arena->top + count > arena->capacity) arena_overflow(arena);
+    struct config *ptr = arena->base + arena->top;
+    arena->top += count;
+    return ptr;
+}
+
+static inline size_t arena_mark(struct search_arena *arena) {
+    return arena->top;
+}
+
+// Free everything pushed since mark was taken
+static inline void arena_release(struct search_arena *arena, size_t mark) {
+    arena->top = mark;
+}
+
+// Node Statistics
+static inline void mem_count_node(void) {
+    if (mem_thread_counter) {
+        mem_thread_counter->nodes++;
+    } else {
+        #pragma omp atomic
+        mem_stray_nodes++;
+    }
+}
+
+void mem_reset_nodes(void);
+long long mem_nodes_searched(void);
+
+#endif